@@ -51,6 +51,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, assign) INTUAuthorizationType preferredAuthorizationType;
 
+/** The maximum amount of time (in seconds) to spend delivering the backlog of batched location updates during each background wake (loading and
+    saving the backlog are not limited). If this value is 0.0 (the default), only the most recent location of each batch is processed. */
+@property (nonatomic, assign) NSTimeInterval batchProcessingTimeBudget;
+
 #pragma mark Location Requests
 
 /**
@@ -162,6 +166,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (INTULocationRequestID)subscribeToSignificantLocationChangesWithBlock:(INTULocationRequestBlock)block;
 
+/**
+ Creates a subscription for significant location changes that will execute the block once per batch of location updates indefinitely (until canceled).
+ Each batch contains the valid locations delivered by the system, ordered from oldest to newest. Batches are also ordered relative to each other:
+ locations that are not newer than one in an earlier batch are skipped. See batchProcessingTimeBudget for how batches are processed in the background.
+ If an error occurs, the block will execute with an empty array and a status other than INTULocationStatusSuccess, and the subscription will be kept alive.
+
+ @param block The block to execute every time a batch of updated locations is available.
+              The status will be INTULocationStatusSuccess unless an error occurred; it will never be INTULocationStatusTimedOut.
+
+ @return The location request ID, which can be used to cancel the subscription of significant location changes to this block.
+ */
+- (INTULocationRequestID)subscribeToSignificantLocationChangesWithBatchBlock:(INTULocationBatchBlock)block;
+
 /** Immediately forces completion of the location request with the given requestID (if it exists), and executes the original request block with the results.
     For one-time location requests, this is effectively a manual timeout, and will result in the request completing with status INTULocationStatusTimedOut.
     If the requestID corresponds to a subscription, then the subscription will simply be canceled. */
@@ -69,6 +69,21 @@
 // @[ INTUHeadingRequest *headingRequest1, INTUHeadingRequest *headingRequest2, ... ]
 @property (nonatomic, strong) __INTU_GENERICS(NSArray, INTUHeadingRequest *) *headingRequests;
 
+/** The serial queue used to process batches of location updates off the main thread. Created the first time it is needed. */
+@property (nonatomic, strong) dispatch_queue_t locationBatchQueue;
+/** The file path used to save the backlog of locations that have not yet been delivered by batch processing. */
+@property (nonatomic, copy) NSString *pendingLocationBatchPath;
+/** The newest location delivered to batched subscriptions so far, or nil if none has been delivered yet. */
+@property (nonatomic, strong) CLLocation *lastBatchLocation;
+/** The fixed main thread time (in seconds) that delivering a batch takes, regardless of its size. Only accessed on the location batch queue. */
+@property (nonatomic, assign) NSTimeInterval locationBatchDeliveryOverhead;
+/** The additional main thread time (in seconds) that delivering a batch takes per location. Only accessed on the location batch queue. */
+@property (nonatomic, assign) NSTimeInterval locationBatchDeliveryTimePerLocation;
+/** The wall clock time (in seconds) from receiving the most recent batch until its backlog was saved after delivery. */
+@property (nonatomic, assign) NSTimeInterval lastLocationBatchLatency;
+/** The CPU time (in seconds) used on the location batch queue to process the most recent batch. */
+@property (nonatomic, assign) NSTimeInterval lastLocationBatchCPUTime;
+
 @end
 
 
@@ -145,6 +160,9 @@ static id _sharedInstance;
 #endif /* __IPHONE_8_4 */
 
         _locationRequests = @[];
+
+        NSString *applicationSupportPath = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) firstObject];
+        _pendingLocationBatchPath = [applicationSupportPath stringByAppendingPathComponent:@"INTULocationManager/PendingLocationBatch.archive"];
     }
     return self;
 }
@@ -365,6 +383,27 @@ static id _sharedInstance;
     return locationRequest.requestID;
 }
 
+/**
+ Creates a subscription for significant location changes that will execute the block once per batch of location updates indefinitely (until canceled).
+ If an error occurs, the block will execute with an empty array and a status other than INTULocationStatusSuccess, and the subscription will be kept alive.
+
+ @param block The block to execute every time a batch of updated locations is available.
+              The status will be INTULocationStatusSuccess unless an error occurred; it will never be INTULocationStatusTimedOut.
+
+ @return The location request ID, which can be used to cancel the subscription of significant location changes to this block.
+ */
+- (INTULocationRequestID)subscribeToSignificantLocationChangesWithBatchBlock:(INTULocationBatchBlock)block
+{
+    NSAssert([NSThread isMainThread], @"INTULocationManager should only be called from the main thread.");
+
+    INTULocationRequest *locationRequest = [[INTULocationRequest alloc] initWithType:INTULocationRequestTypeSignificantChanges];
+    locationRequest.batchBlock = block;
+
+    [self addLocationRequest:locationRequest];
+
+    return locationRequest.requestID;
+}
+
 /**
  Immediately forces completion of the location request with the given requestID (if it exists), and executes the original request block with the results.
  This is effectively a manual timeout, and will result in the request completing with status INTULocationStatusTimedOut.
@@ -518,6 +557,32 @@ static id _sharedInstance;
     }
 }
 
+/**
+ Checks whether the given @c CLLocation has a valid, non-zero coordinate.
+ */
+BOOL INTUCLLocationIsValid(CLLocation *location)
+{
+    return CLLocationCoordinate2DIsValid(location.coordinate) &&
+           !(location.coordinate.latitude == 0.0 && location.coordinate.longitude == 0.0);
+}
+
+/**
+ Returns the valid locations in the given array, ordered from oldest to newest.
+ */
+NSArray *INTUValidLocationsSortedByTimestamp(NSArray *locations)
+{
+    NSMutableArray *validLocations = [NSMutableArray arrayWithCapacity:locations.count];
+    for (CLLocation *location in locations) {
+        if (INTUCLLocationIsValid(location)) {
+            [validLocations addObject:location];
+        }
+    }
+    [validLocations sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(CLLocation *location1, CLLocation *location2) {
+        return [location1.timestamp compare:location2.timestamp];
+    }];
+    return validLocations;
+}
+
 /**
  Returns the most recent current location, or nil if the current location is unknown, invalid, or stale.
  */
@@ -525,7 +590,7 @@ static id _sharedInstance;
 {
     if (_currentLocation) {
         // Location isn't nil, so test to see if it is valid
-        if (!CLLocationCoordinate2DIsValid(_currentLocation.coordinate) || (_currentLocation.coordinate.latitude == 0.0 && _currentLocation.coordinate.longitude == 0.0)) {
+        if (!INTUCLLocationIsValid(_currentLocation)) {
             // The current location is invalid; discard it and return nil
             _currentLocation = nil;
         }
@@ -731,10 +796,28 @@ static id _sharedInstance;
  successfully satisfies any of their criteria.
  */
 - (void)processLocationRequests
+{
+    [self processLocationRequestsWithLocationBatch:nil];
+}
+
+/**
+ Iterates over the array of active location requests to check and see if the most recent current location
+ successfully satisfies any of their criteria. Batched subscriptions receive the given batch of locations,
+ and are skipped if it is empty or nil (e.g. when processing is triggered by adding a new location request).
+ */
+- (void)processLocationRequestsWithLocationBatch:(NSArray *)locationBatch
 {
     CLLocation *mostRecentLocation = self.currentLocation;
 
     for (INTULocationRequest *locationRequest in self.locationRequests) {
+        if (locationRequest.batchBlock) {
+            // This is a batched subscription request, which receives every batch of location updates we get
+            if (locationBatch.count > 0) {
+                [self processRecurringBatchRequest:locationRequest withLocations:locationBatch];
+            }
+            continue;
+        }
+
         if (locationRequest.hasTimedOut) {
             // Non-recurring request has timed out, complete it
             [self completeLocationRequest:locationRequest];
@@ -800,6 +883,9 @@ static id _sharedInstance;
         if (locationRequest.block) {
             locationRequest.block(currentLocation, achievedAccuracy, status);
         }
+        if (locationRequest.batchBlock) {
+            locationRequest.batchBlock(@[], status);
+        }
     });
 
     INTULMLog(@"Location Request completed with ID: %ld, currentLocation: %@, achievedAccuracy: %lu, status: %lu", (long)locationRequest.requestID, currentLocation, (unsigned long) achievedAccuracy, (unsigned long)status);
@@ -825,6 +911,57 @@ static id _sharedInstance;
     });
 }
 
+/**
+ Handles calling a batched location request's block with the given batch of locations.
+ */
+- (void)processRecurringBatchRequest:(INTULocationRequest *)locationRequest withLocations:(NSArray *)locations
+{
+    NSAssert(locationRequest.isRecurring, @"This method should only be called for recurring location requests.");
+
+    INTULocationStatus status = [self statusForLocationRequest:locationRequest];
+    NSArray *batch = (status == INTULocationStatusSuccess) ? locations : @[];
+
+    // dispatch_async is used to ensure that the completion block for a request is not executed before the request ID is returned.
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (locationRequest.batchBlock) {
+            locationRequest.batchBlock(batch, status);
+        }
+    });
+}
+
+/**
+ Iterates over the array of active location requests and calls each batched subscription's block with the given batch of locations.
+ */
+- (void)processBatchLocationRequestsWithLocations:(NSArray *)locations
+{
+    for (INTULocationRequest *locationRequest in self.locationRequests) {
+        if (locationRequest.batchBlock) {
+            [self processRecurringBatchRequest:locationRequest withLocations:locations];
+        }
+    }
+}
+
+/**
+ Returns the locations in the given batch (ordered from oldest to newest) that are newer than every location already delivered
+ to batched subscriptions, and records the newest of them as delivered. This keeps batches in order across deliveries.
+ */
+- (NSArray *)locationsAfterLastBatchLocation:(NSArray *)locations
+{
+    if (self.lastBatchLocation != nil) {
+        NSUInteger firstNewIndex = [locations indexOfObject:self.lastBatchLocation
+                                              inSortedRange:NSMakeRange(0, locations.count)
+                                                    options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                                            usingComparator:^NSComparisonResult(CLLocation *location1, CLLocation *location2) {
+                                                return [location1.timestamp compare:location2.timestamp];
+                                            }];
+        locations = [locations subarrayWithRange:NSMakeRange(firstNewIndex, locations.count - firstNewIndex)];
+    }
+    if (locations.count > 0) {
+        self.lastBatchLocation = [locations lastObject];
+    }
+    return locations;
+}
+
 /**
  Returns all active location requests with the given type.
  */
@@ -912,6 +1049,198 @@ static id _sharedInstance;
     }
 }
 
+#pragma mark Internal location batch methods
+
+/**
+ Sets the batch processing time budget. When batch processing is disabled, any backlog it saved is deleted, since it will never be delivered.
+ */
+- (void)setBatchProcessingTimeBudget:(NSTimeInterval)batchProcessingTimeBudget
+{
+    BOOL wasProcessingBatches = _batchProcessingTimeBudget > 0.0;
+    _batchProcessingTimeBudget = batchProcessingTimeBudget;
+
+    if (wasProcessingBatches && batchProcessingTimeBudget <= 0.0) {
+        [self discardPendingLocationBatch];
+    }
+}
+
+/**
+ Returns the serial queue used to process batches of location updates, creating it the first time it is needed.
+ */
+- (dispatch_queue_t)locationBatchQueue
+{
+    if (_locationBatchQueue == nil) {
+        _locationBatchQueue = dispatch_queue_create("com.intuit.INTULocationManager.locationBatch", DISPATCH_QUEUE_SERIAL);
+    }
+    return _locationBatchQueue;
+}
+
+/**
+ Processes the given batch of locations on the location batch queue.
+ The batch is merged with the backlog left undelivered by earlier batches (capped at kINTULocationBatchBacklogLimit locations,
+ dropping the oldest first), and the backlog is saved to disk before anything is delivered. The newest location is always delivered
+ to the location requests, while the batched subscriptions receive as many of the oldest locations as fit in what is left of the
+ time budget. The backlog on disk is then trimmed to the locations that the batched subscriptions have not yet received.
+ */
+- (void)processLocationBatch:(NSArray *)locations
+{
+    // The time budget starts when the batch is received, so that waiting behind an earlier batch counts against it
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSTimeInterval timeBudget = self.batchProcessingTimeBudget;
+    NSString *pendingLocationBatchPath = self.pendingLocationBatchPath;
+
+    dispatch_async(self.locationBatchQueue, ^{
+        struct timespec startCPUTime;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &startCPUTime);
+
+        // Locations left undelivered by earlier batches are merged back in, so that the oldest are delivered first
+        NSArray *pendingLocations = [self loadPendingLocationBatchFromPath:pendingLocationBatchPath];
+        NSArray *backlog = INTUValidLocationsSortedByTimestamp([pendingLocations arrayByAddingObjectsFromArray:locations]);
+        if (backlog.count > kINTULocationBatchBacklogLimit) {
+            INTULMLog(@"Location batch backlog is full, dropping the %lu oldest locations.", (unsigned long)(backlog.count - kINTULocationBatchBacklogLimit));
+            backlog = [backlog subarrayWithRange:NSMakeRange(backlog.count - kINTULocationBatchBacklogLimit, kINTULocationBatchBacklogLimit)];
+        }
+
+        NSUInteger deliveryCount = 0;
+        NSTimeInterval deliveryDuration = 0.0;
+        if (backlog.count == 0) {
+            [self savePendingLocationBatch:backlog toPath:pendingLocationBatchPath];
+        } else {
+            // Save the whole backlog before delivering anything, so that nothing is lost if the app is suspended or terminated during delivery
+            CFAbsoluteTime saveStartTime = CFAbsoluteTimeGetCurrent();
+            [self savePendingLocationBatch:backlog toPath:pendingLocationBatchPath];
+            NSTimeInterval saveDuration = CFAbsoluteTimeGetCurrent() - saveStartTime;
+
+            // Delivery costs a fixed overhead plus a cost per location, both measured from earlier deliveries. Deliver as many of the
+            // oldest locations as the time remaining allows, keeping enough in reserve to save whatever is left (which costs no more
+            // than saving the whole backlog did). At least one is always delivered, so the backlog keeps draining.
+            NSTimeInterval remainingTime = timeBudget - (CFAbsoluteTimeGetCurrent() - startTime) - saveDuration - self.locationBatchDeliveryOverhead;
+            deliveryCount = 1;
+            if (remainingTime > 0.0) {
+                deliveryCount = backlog.count;
+                if (self.locationBatchDeliveryTimePerLocation > 0.0) {
+                    double affordableCount = floor(remainingTime / self.locationBatchDeliveryTimePerLocation);
+                    deliveryCount = (NSUInteger)MAX(1.0, MIN((double)backlog.count, affordableCount));
+                }
+            }
+            NSArray *deliveredLocations = [backlog subarrayWithRange:NSMakeRange(0, deliveryCount)];
+            CLLocation *newestLocation = [backlog lastObject];
+
+            // Wait for the delivery to finish (including the subscription blocks, which are dispatched asynchronously to the main queue),
+            // so that the next batch never reads back locations that have already been delivered. The main thread never waits on the
+            // location batch queue, so this cannot deadlock. The delivery time is measured on the main thread, so that it does not
+            // include waiting for the main thread to become available.
+            __block CFAbsoluteTime deliveryStartTime = 0.0;
+            __block CFAbsoluteTime deliveryEndTime = 0.0;
+            dispatch_sync(dispatch_get_main_queue(), ^{
+                deliveryStartTime = CFAbsoluteTimeGetCurrent();
+                [self completeLocationBatch:deliveredLocations newestLocation:newestLocation];
+            });
+            dispatch_sync(dispatch_get_main_queue(), ^{
+                deliveryEndTime = CFAbsoluteTimeGetCurrent();
+            });
+            deliveryDuration = deliveryEndTime - deliveryStartTime;
+
+            // Delivering a single location is almost all overhead, while larger deliveries show the cost per location on top of it
+            if (deliveryCount == 1) {
+                self.locationBatchDeliveryOverhead = deliveryDuration;
+            } else {
+                self.locationBatchDeliveryTimePerLocation = MAX(0.0, deliveryDuration - self.locationBatchDeliveryOverhead) / deliveryCount;
+            }
+
+            [self savePendingLocationBatch:[backlog subarrayWithRange:NSMakeRange(deliveryCount, backlog.count - deliveryCount)] toPath:pendingLocationBatchPath];
+        }
+
+        struct timespec endCPUTime;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &endCPUTime);
+        NSTimeInterval latency = CFAbsoluteTimeGetCurrent() - startTime;
+        NSTimeInterval cpuTime = (endCPUTime.tv_sec - startCPUTime.tv_sec) + (endCPUTime.tv_nsec - startCPUTime.tv_nsec) / 1e9;
+        INTULMLog(@"Processed location batch in %.3f ms (%.3f ms CPU, %.3f ms delivering on the main thread): delivered %lu locations, saved %lu for the next batch.", latency * 1000.0, cpuTime * 1000.0, deliveryDuration * 1000.0, (unsigned long)deliveryCount, (unsigned long)(backlog.count - deliveryCount));
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self.lastLocationBatchLatency = latency;
+            self.lastLocationBatchCPUTime = cpuTime;
+        });
+    });
+}
+
+/**
+ Delivers a processed batch. If the newest location in the backlog advances the current location, every location request is processed
+ once using it; otherwise only the batched subscriptions are processed. Batched subscriptions receive the given locations (ordered from
+ oldest to newest), skipping any that are not newer than one already delivered to them.
+ */
+- (void)completeLocationBatch:(NSArray *)locations newestLocation:(CLLocation *)newestLocation
+{
+    // Received update successfully, so clear any previous errors
+    self.updateFailed = NO;
+
+    NSArray *newLocations = [self locationsAfterLastBatchLocation:locations];
+    if (_currentLocation == nil || [newestLocation.timestamp compare:_currentLocation.timestamp] == NSOrderedDescending) {
+        self.currentLocation = newestLocation;
+        [self processLocationRequestsWithLocationBatch:newLocations];
+    } else if (newLocations.count > 0) {
+        // The current location has not advanced, so only the batched subscriptions have anything new to receive
+        [self processBatchLocationRequestsWithLocations:newLocations];
+    }
+}
+
+/**
+ Deletes the backlog of locations saved by batch processing.
+ */
+- (void)discardPendingLocationBatch
+{
+    NSString *pendingLocationBatchPath = self.pendingLocationBatchPath;
+    dispatch_async(self.locationBatchQueue, ^{
+        [self savePendingLocationBatch:@[] toPath:pendingLocationBatchPath];
+    });
+}
+
+/**
+ Returns the backlog of locations saved at the given path, or an empty array if there is none.
+ The file is left in place until the backlog has been delivered. Must be called on the location batch queue.
+ */
+- (NSArray *)loadPendingLocationBatchFromPath:(NSString *)path
+{
+    NSData *data = [NSData dataWithContentsOfFile:path];
+    if (data == nil) {
+        return @[];
+    }
+
+    NSError *error = nil;
+    NSArray *locations = [NSKeyedUnarchiver unarchivedObjectOfClasses:[NSSet setWithObjects:[NSArray class], [CLLocation class], nil]
+                                                             fromData:data
+                                                                error:&error];
+    if (![locations isKindOfClass:[NSArray class]]) {
+        INTULMLog(@"Discarding unreadable pending location batch: %@", [error localizedDescription]);
+        return @[];
+    }
+    return locations;
+}
+
+/**
+ Saves the given backlog of locations at the given path, or deletes the file if the backlog is empty.
+ Must be called on the location batch queue.
+ */
+- (void)savePendingLocationBatch:(NSArray *)locations toPath:(NSString *)path
+{
+    if (locations.count == 0) {
+        [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+        return;
+    }
+
+    NSError *error = nil;
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:locations requiringSecureCoding:YES error:&error];
+    if (data == nil) {
+        INTULMLog(@"Failed to archive pending location batch: %@", [error localizedDescription]);
+        return;
+    }
+
+    [[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:nil];
+    if (![data writeToFile:path options:NSDataWritingAtomic error:&error]) {
+        INTULMLog(@"Failed to save pending location batch: %@", [error localizedDescription]);
+    }
+}
+
 #pragma mark Internal heading methods
 
 /**
@@ -1080,14 +1409,29 @@ BOOL INTUCLHeadingIsIsValid(CLHeading *heading)
 
 - (void)locationManager:(CLLocationManager *)manager didUpdateLocations:(NSArray *)locations
 {
+    if (self.batchProcessingTimeBudget > 0.0) {
+        // Process the entire batch off the main thread, then process the location requests once using the newest location
+        [self processLocationBatch:locations];
+        return;
+    }
+
     // Received update successfully, so clear any previous errors
     self.updateFailed = NO;
 
     CLLocation *mostRecentLocation = [locations lastObject];
     self.currentLocation = mostRecentLocation;
 
+    // Only validate and order the batch if there is a batched subscription to receive it
+    NSArray *locationBatch = nil;
+    NSUInteger batchRequestIndex = [self.locationRequests indexOfObjectPassingTest:^BOOL(INTULocationRequest *locationRequest, NSUInteger index, BOOL *stop) {
+        return locationRequest.batchBlock != nil;
+    }];
+    if (batchRequestIndex != NSNotFound) {
+        locationBatch = [self locationsAfterLastBatchLocation:INTUValidLocationsSortedByTimestamp(locations)];
+    }
+
     // Process the location requests using the updated location
-    [self processLocationRequests];
+    [self processLocationRequestsWithLocationBatch:locationBatch];
 }
 
 - (void)locationManager:(CLLocationManager *)manager didUpdateHeading:(CLHeading *)newHeading
@@ -1104,7 +1448,10 @@ BOOL INTUCLHeadingIsIsValid(CLHeading *heading)
     self.updateFailed = YES;
 
     for (INTULocationRequest *locationRequest in self.locationRequests) {
-        if (locationRequest.isRecurring) {
+        if (locationRequest.batchBlock) {
+            // Keep the batched request alive
+            [self processRecurringBatchRequest:locationRequest withLocations:@[]];
+        } else if (locationRequest.isRecurring) {
             // Keep the recurring request alive
             [self processRecurringRequest:locationRequest];
         } else {
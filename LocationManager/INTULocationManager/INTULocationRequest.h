@@ -80,6 +80,8 @@ typedef NS_ENUM(NSInteger, INTULocationRequestType) {
 @property (nonatomic, readonly) BOOL hasTimedOut;
 /** The block to execute when the location request completes. */
 @property (nonatomic, copy, nullable) INTULocationRequestBlock block;
+/** The block to execute with each batch of location updates. Only set for batched subscriptions, which never have a |block|. */
+@property (nonatomic, copy, nullable) INTULocationBatchBlock batchBlock;
 
 /** Designated initializer. Initializes and returns a newly allocated location request object with the specified type. */
 - (instancetype)initWithType:(INTULocationRequestType)type __INTU_DESIGNATED_INITIALIZER;
@@ -53,6 +53,8 @@ static const NSTimeInterval kINTUUpdateTimeStaleThresholdBlock =             60.
 static const NSTimeInterval kINTUUpdateTimeStaleThresholdHouse =             15.0;  // in seconds
 static const NSTimeInterval kINTUUpdateTimeStaleThresholdRoom =               5.0;  // in seconds
 
+static const NSUInteger kINTULocationBatchBacklogLimit =                    10000;  // in locations
+
 /** The possible states that location services can be in. */
 typedef NS_ENUM(NSInteger, INTULocationServicesState) {
     /** User has already granted this app permissions to access location services, and they are enabled and ready for use by this app.
@@ -152,6 +154,15 @@ typedef NS_ENUM(NSInteger, INTUHeadingStatus) {
  */
 typedef void(^INTULocationRequestBlock)(CLLocation *currentLocation, INTULocationAccuracy achievedAccuracy, INTULocationStatus status);
 
+/**
+ A block type for a batched location subscription, which is executed once for every batch of location updates delivered by the system.
+
+ @param locations The valid locations in the batch, ordered from oldest to newest. Every location is newer than all of the locations in
+                  earlier batches. This will be empty if an error occurred.
+ @param status    The status of the subscription - whether the batch was delivered successfully or some sort of error occurred.
+ */
+typedef void(^INTULocationBatchBlock)(__INTU_GENERICS(NSArray, CLLocation *) *locations, INTULocationStatus status);
+
 /**
  A block type for a heading request, which is executed when the request succeeds.
 
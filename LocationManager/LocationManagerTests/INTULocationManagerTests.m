@@ -33,8 +33,25 @@
 @interface INTULocationManager (Spec) <CLLocationManagerDelegate>
 @property (nonatomic, strong) CLLocationManager *locationManager;
 @property (nonatomic, assign) BOOL isUpdatingHeading;
+@property (nonatomic, copy) NSString *pendingLocationBatchPath;
+@property (nonatomic, assign) NSTimeInterval lastLocationBatchLatency;
+@property (nonatomic, assign) NSTimeInterval lastLocationBatchCPUTime;
 @end
 
+/** Returns a synthetic batch of valid locations, ordered from oldest to newest, with the newest received just now. */
+static NSArray<CLLocation *> *INTUSyntheticLocationBatch(NSUInteger count)
+{
+    NSMutableArray<CLLocation *> *locations = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [locations addObject:[[CLLocation alloc] initWithCoordinate:CLLocationCoordinate2DMake(1 + i * 0.0001, 1)
+                                                           altitude:CLLocationDistanceMax
+                                                 horizontalAccuracy:kCLLocationAccuracyBest
+                                                   verticalAccuracy:kCLLocationAccuracyBest
+                                                          timestamp:[NSDate dateWithTimeIntervalSinceNow:-(double)(count - 1 - i) * 0.01]]];
+    }
+    return locations;
+}
+
 SpecBegin(LocationManager)
 
 __block INTULocationManager *subject;
@@ -617,6 +634,191 @@ describe(@"multiple simultaneous location requests", ^{
     });
 });
 
+describe(@"processing batched location updates in the background", ^{
+    __block id classMock;
+
+    before(^{
+        classMock = OCMClassMock(CLLocationManager.class);
+        OCMStub(ClassMethod([classMock locationServicesEnabled])).andReturn(YES);
+        OCMStub(ClassMethod([classMock authorizationStatus])).andReturn(kCLAuthorizationStatusAuthorizedAlways);
+
+        subject.pendingLocationBatchPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+        subject.batchProcessingTimeBudget = 5.0;
+    });
+
+    after(^{
+        [[NSFileManager defaultManager] removeItemAtPath:subject.pendingLocationBatchPath error:nil];
+        [classMock stopMocking];
+    });
+
+    it(@"delivers a large batch in order to batched subscriptions without blocking the main thread", ^{
+        NSArray<CLLocation *> *locations = INTUSyntheticLocationBatch(kINTULocationBatchBacklogLimit);
+        NSMutableArray<CLLocation *> *shuffledLocations = [[[locations reverseObjectEnumerator] allObjects] mutableCopy];
+        [shuffledLocations insertObject:[[CLLocation alloc] initWithLatitude:0 longitude:0] atIndex:shuffledLocations.count / 2];
+
+        __block NSArray<CLLocation *> *deliveredLocations = nil;
+        __block CFAbsoluteTime mainThreadTime = 0.0;
+        waitUntil(^(DoneCallback done) {
+            [subject subscribeToSignificantLocationChangesWithBatchBlock:^(NSArray<CLLocation *> *batch, INTULocationStatus status) {
+                deliveredLocations = batch;
+                done();
+            }];
+            CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+            [subject locationManager:subject.locationManager didUpdateLocations:shuffledLocations];
+            mainThreadTime = CFAbsoluteTimeGetCurrent() - startTime;
+        });
+
+        // The invalid location is dropped, and the rest are delivered oldest first
+        expect(deliveredLocations).to.equal(locations);
+        expect(mainThreadTime).to.beLessThan(0.05);
+        expect(subject.lastLocationBatchLatency).will.beGreaterThan(0.0);
+        expect(subject.lastLocationBatchLatency).to.beLessThan(subject.batchProcessingTimeBudget);
+        expect([[NSFileManager defaultManager] fileExistsAtPath:subject.pendingLocationBatchPath]).to.beFalsy();
+    });
+
+    it(@"drops the oldest locations beyond the backlog limit", ^{
+        NSArray<CLLocation *> *locations = INTUSyntheticLocationBatch(kINTULocationBatchBacklogLimit + 100);
+
+        __block NSArray<CLLocation *> *deliveredLocations = nil;
+        [subject subscribeToSignificantLocationChangesWithBatchBlock:^(NSArray<CLLocation *> *batch, INTULocationStatus status) {
+            deliveredLocations = batch;
+        }];
+        [subject locationManager:subject.locationManager didUpdateLocations:locations];
+
+        expect(deliveredLocations.count).will.equal(kINTULocationBatchBacklogLimit);
+        expect(deliveredLocations.firstObject).to.equal(locations[100]);
+        expect(deliveredLocations.lastObject).to.equal(locations.lastObject);
+    });
+
+    it(@"delivers one coalesced update with the newest location to each subscription", ^{
+        // The newest location is not the last one delivered by the system, so only batch processing will find it
+        NSMutableArray<CLLocation *> *locations = [INTUSyntheticLocationBatch(10000) mutableCopy];
+        CLLocation *newestLocation = locations.lastObject;
+        [locations exchangeObjectAtIndex:locations.count - 1 withObjectAtIndex:locations.count / 2];
+
+        __block NSInteger callbackCount = 0;
+        __block CLLocation *deliveredLocation = nil;
+        [subject subscribeToLocationUpdatesWithBlock:^(CLLocation *currentLocation, INTULocationAccuracy achievedAccuracy, INTULocationStatus status) {
+            callbackCount++;
+            deliveredLocation = currentLocation;
+        }];
+        [subject locationManager:subject.locationManager didUpdateLocations:locations];
+
+        // The metrics are recorded after the subscription blocks have run
+        expect(subject.lastLocationBatchLatency).will.beGreaterThan(0.0);
+        expect(callbackCount).to.equal(1);
+        expect(deliveredLocation).to.equal(newestLocation);
+    });
+
+    it(@"delivers the newest location to subscriptions even when the batch is only partly delivered", ^{
+        NSArray<CLLocation *> *locations = INTUSyntheticLocationBatch(kINTULocationBatchBacklogLimit);
+        subject.batchProcessingTimeBudget = 0.001;
+
+        __block CLLocation *deliveredLocation = nil;
+        __block NSArray<CLLocation *> *deliveredBatch = nil;
+        [subject subscribeToLocationUpdatesWithBlock:^(CLLocation *currentLocation, INTULocationAccuracy achievedAccuracy, INTULocationStatus status) {
+            deliveredLocation = currentLocation;
+        }];
+        [subject subscribeToSignificantLocationChangesWithBatchBlock:^(NSArray<CLLocation *> *batch, INTULocationStatus status) {
+            deliveredBatch = batch;
+        }];
+        [subject locationManager:subject.locationManager didUpdateLocations:locations];
+
+        expect(subject.lastLocationBatchLatency).will.beGreaterThan(0.0);
+        expect(deliveredLocation).to.equal(locations.lastObject);
+        expect(subject.currentLocation).to.equal(locations.lastObject);
+        expect(deliveredBatch.count).to.beLessThan(locations.count);
+        expect(deliveredBatch.firstObject).to.equal(locations.firstObject);
+    });
+
+    it(@"does not call subscriptions again when a batch does not advance the current location", ^{
+        NSArray<CLLocation *> *olderLocations = INTUSyntheticLocationBatch(100);
+        CLLocation *newestLocation = INTUSyntheticLocationBatch(1).firstObject;
+
+        __block NSInteger callbackCount = 0;
+        [subject subscribeToLocationUpdatesWithBlock:^(CLLocation *currentLocation, INTULocationAccuracy achievedAccuracy, INTULocationStatus status) {
+            callbackCount++;
+        }];
+
+        subject.batchProcessingTimeBudget = 0.0;
+        [subject locationManager:subject.locationManager didUpdateLocations:@[newestLocation]];
+        expect(callbackCount).will.equal(1);
+
+        subject.batchProcessingTimeBudget = 5.0;
+        [subject locationManager:subject.locationManager didUpdateLocations:olderLocations];
+        expect(subject.lastLocationBatchLatency).will.beGreaterThan(0.0);
+        expect(callbackCount).to.equal(1);
+    });
+
+    it(@"never delivers a location older than one from an earlier batch", ^{
+        NSArray<CLLocation *> *firstLocations = INTUSyntheticLocationBatch(10);
+        CLLocation *olderLocation = [[CLLocation alloc] initWithCoordinate:CLLocationCoordinate2DMake(2, 2)
+                                                                  altitude:CLLocationDistanceMax
+                                                        horizontalAccuracy:kCLLocationAccuracyBest
+                                                          verticalAccuracy:kCLLocationAccuracyBest
+                                                                 timestamp:[NSDate dateWithTimeIntervalSinceNow:-60.0]];
+        CLLocation *newerLocation = [[CLLocation alloc] initWithCoordinate:CLLocationCoordinate2DMake(2, 2)
+                                                                  altitude:CLLocationDistanceMax
+                                                        horizontalAccuracy:kCLLocationAccuracyBest
+                                                          verticalAccuracy:kCLLocationAccuracyBest
+                                                                 timestamp:[NSDate dateWithTimeIntervalSinceNow:1.0]];
+
+        NSMutableArray<NSArray<CLLocation *> *> *deliveredBatches = [NSMutableArray array];
+        [subject subscribeToSignificantLocationChangesWithBatchBlock:^(NSArray<CLLocation *> *batch, INTULocationStatus status) {
+            [deliveredBatches addObject:batch];
+        }];
+
+        [subject locationManager:subject.locationManager didUpdateLocations:firstLocations];
+        expect(deliveredBatches.count).will.equal(1);
+
+        [subject locationManager:subject.locationManager didUpdateLocations:@[olderLocation, newerLocation]];
+        expect(deliveredBatches.count).will.equal(2);
+        expect(deliveredBatches[1]).to.equal(@[newerLocation]);
+    });
+
+    it(@"delivers only the oldest location when the budget is used up and carries the rest over to the next batch", ^{
+        NSArray<CLLocation *> *locations = INTUSyntheticLocationBatch(kINTULocationBatchBacklogLimit);
+        subject.batchProcessingTimeBudget = 0.001;
+
+        NSMutableArray<NSArray<CLLocation *> *> *deliveredBatches = [NSMutableArray array];
+        [subject subscribeToSignificantLocationChangesWithBatchBlock:^(NSArray<CLLocation *> *batch, INTULocationStatus status) {
+            [deliveredBatches addObject:batch];
+        }];
+        [subject locationManager:subject.locationManager didUpdateLocations:locations];
+
+        // Saving the backlog alone uses up the budget, so only the oldest location is delivered and the rest stay on disk
+        expect(subject.lastLocationBatchLatency).will.beGreaterThan(0.0);
+        expect(subject.lastLocationBatchCPUTime).to.beGreaterThan(0.0);
+        expect(deliveredBatches.count).to.equal(1);
+        expect(deliveredBatches[0]).to.equal(@[locations.firstObject]);
+        expect([[NSFileManager defaultManager] fileExistsAtPath:subject.pendingLocationBatchPath]).to.beTruthy();
+
+        // The next wake has enough time to deliver everything left over, along with its own location
+        NSUInteger firstBatchCount = deliveredBatches[0].count;
+        CLLocation *newestLocation = INTUSyntheticLocationBatch(1).firstObject;
+        subject.lastLocationBatchLatency = 0.0;
+        subject.batchProcessingTimeBudget = 5.0;
+        [subject locationManager:subject.locationManager didUpdateLocations:@[newestLocation]];
+
+        expect(subject.lastLocationBatchLatency).will.beGreaterThan(0.0);
+        expect(deliveredBatches.count).to.equal(2);
+        expect(deliveredBatches[1].count).to.equal(locations.count - firstBatchCount + 1);
+        expect(deliveredBatches[1].firstObject).to.equal(locations[firstBatchCount]);
+        expect(deliveredBatches[1].lastObject).to.equal(newestLocation);
+        expect([[NSFileManager defaultManager] fileExistsAtPath:subject.pendingLocationBatchPath]).to.beFalsy();
+    });
+
+    it(@"deletes the saved backlog once batch processing is disabled", ^{
+        subject.batchProcessingTimeBudget = 0.001;
+        [subject locationManager:subject.locationManager didUpdateLocations:INTUSyntheticLocationBatch(kINTULocationBatchBacklogLimit)];
+        expect(subject.lastLocationBatchLatency).will.beGreaterThan(0.0);
+        expect([[NSFileManager defaultManager] fileExistsAtPath:subject.pendingLocationBatchPath]).to.beTruthy();
+
+        subject.batchProcessingTimeBudget = 0.0;
+        expect([[NSFileManager defaultManager] fileExistsAtPath:subject.pendingLocationBatchPath]).will.beFalsy();
+    });
+});
+
 xdescribe(@"when determining whether a location update fulfills a request", ^{
     // The logic comparing a request's desired accuracy to the CLLocation's properties
     // (all the stuff regarding staleness + horizontal location accuracy threshold)